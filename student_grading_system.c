@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <time.h>
 
 #define MAX_STUDENTS 200    // Maximum number of students the system can store
 #define NUM_SUBJECTS 3      // Default number of subjects per student
@@ -9,6 +11,13 @@
 #define MAX_NAME_LENGTH 50  // Maximum length for student name
 #define DATA_FILENAME "students.txt"  // Default filename for student data
 #define REPORT_FILENAME "class_report.txt"  // Default filename for class report
+#define FILTER_FILENAME "filter_results.txt"  // Default filename for exported filter results
+#define NUM_GRADES 5        // Number of letter grades (A, B, C, D, F)
+#define BITMAP_WORDS ((MAX_STUDENTS + 31) / 32)  // 32-bit words needed for one bit per record
+#define MAX_FILTER_LENGTH 200  // Maximum length of a filter expression
+#define MAX_FILTER_TOKENS 64   // Maximum number of tokens in a filter expression
+#define MAX_TOKEN_LENGTH 16    // Maximum length of a single filter token
+#define MAX_FILTER_NODES 64    // Maximum number of nodes in a parsed filter expression
 
 // Student structure definition
 typedef struct {
@@ -20,10 +29,53 @@ typedef struct {
     int active;  // 1 = active, 0 = deleted
 } Student;
 
+// Set of record positions, one bit per student slot
+typedef struct {
+    uint32_t words[BITMAP_WORDS];
+} Bitmap;
+
+// Indexes built over the record store for filter queries
+typedef struct {
+    int count;
+    Bitmap gradeBits[NUM_GRADES];  // Equality index on grade (A, B, C, D, F)
+    Bitmap activeBits[2];          // Equality index on active status (0, 1)
+    float averageCol[MAX_STUDENTS];             // Column of averages for range scans
+    int markCol[NUM_SUBJECTS][MAX_STUDENTS];    // One column per subject for range scans
+} FilterIndex;
+
+typedef enum { NODE_AND, NODE_OR, NODE_NOT, NODE_PREDICATE } FilterNodeType;
+typedef enum { FIELD_GRADE, FIELD_ACTIVE, FIELD_AVERAGE, FIELD_MARK, FIELD_ANY_MARK, FIELD_ALL_MARKS } FilterField;
+typedef enum { OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE } FilterOp;
+
+// Node of a parsed filter expression
+typedef struct {
+    FilterNodeType type;
+    int left;       // Child node index (AND, OR, NOT)
+    int right;      // Child node index (AND, OR)
+    FilterField field;
+    int subject;    // Subject index for FIELD_MARK
+    FilterOp op;
+    float value;    // Numeric operand for average, marks and active
+    char grade;     // Letter operand for grade
+} FilterNode;
+
+// Parser state and result for one filter expression
+typedef struct {
+    char tokens[MAX_FILTER_TOKENS][MAX_TOKEN_LENGTH];
+    int tokenCount;
+    int pos;
+    FilterNode nodes[MAX_FILTER_NODES];
+    int nodeCount;
+    int root;
+    int usesActive;  // 1 if the expression mentions the active field
+    char error[100];
+} FilterQuery;
+
 // Function prototypes
 void displayMenu();
 void loadFromFile(const char *filename, Student arr[], int *count);
 void saveToFile(const char *filename, Student arr[], int count);
+void writeStudentRecord(FILE *file, const Student *s);
 void addStudent(Student arr[], int *count);
 void listStudents(Student arr[], int count);
 int findStudentIndexByID(Student arr[], int count, const char *id);
@@ -33,6 +85,27 @@ void searchStudent(Student arr[], int count);
 float calculateAverage(int marks[], int n);
 char calculateGrade(float avg);
 void generateReport(Student arr[], int count);
+void filterStudents(Student arr[], int count);
+void buildFilterIndex(Student arr[], int count, FilterIndex *index);
+int parseFilter(const char *text, FilterQuery *query);
+int tokenizeFilter(const char *text, FilterQuery *query);
+int parseFilterOr(FilterQuery *query);
+int parseFilterAnd(FilterQuery *query);
+int parseFilterUnary(FilterQuery *query);
+int parseFilterPredicate(FilterQuery *query);
+int addFilterNode(FilterQuery *query, FilterNodeType type, int left, int right);
+void evaluateFilter(FilterQuery *query, int node, FilterIndex *index, Bitmap *out);
+void scanColumnFloat(const float col[], int count, FilterOp op, float value, Bitmap *out);
+void scanColumnInt(const int col[], int count, FilterOp op, float value, Bitmap *out);
+int compareValue(float x, FilterOp op, float value);
+int gradeSlot(char grade);
+void bitmapClear(Bitmap *b);
+void bitmapSet(Bitmap *b, int i);
+int bitmapTest(const Bitmap *b, int i);
+void bitmapAnd(Bitmap *dst, const Bitmap *src);
+void bitmapOr(Bitmap *dst, const Bitmap *src);
+void bitmapNot(Bitmap *b, int count);
+double currentTimeMs();
 void clearInputBuffer();
 int getIntegerInput(int min, int max);
 void waitForEnter();
@@ -49,7 +122,7 @@ int main() {
     do {
         displayMenu();
         printf("Enter your choice: ");
-        choice = getIntegerInput(1, 8);
+        choice = getIntegerInput(1, 9);
         
         switch (choice) {
             case 1:
@@ -71,18 +144,21 @@ int main() {
                 generateReport(students, studentCount);
                 break;
             case 7:
+                filterStudents(students, studentCount);
+                break;
+            case 8:
                 saveToFile(DATA_FILENAME, students, studentCount);
                 printf("\nData saved successfully to %s\n", DATA_FILENAME);
                 waitForEnter();
                 break;
-            case 8:
+            case 9:
                 saveToFile(DATA_FILENAME, students, studentCount);
                 printf("\nData saved to %s. Exiting program...\n", DATA_FILENAME);
                 break;
             default:
                 printf("Invalid choice. Please try again.\n");
         }
-    } while (choice != 8);
+    } while (choice != 9);
     
     return 0;
 }
@@ -102,8 +178,9 @@ void displayMenu() {
     printf("4. Update Student\n");
     printf("5. Delete Student\n");
     printf("6. Generate Class Report\n");
-    printf("7. Save Data\n");
-    printf("8. Exit\n");
+    printf("7. Filter Students\n");
+    printf("8. Save Data\n");
+    printf("9. Exit\n");
     printf("\n");
 }
 
@@ -191,24 +268,28 @@ void saveToFile(const char *filename, Student arr[], int count) {
     }
     
     for (int i = 0; i < count; i++) {
-        // Write student data to file in the required format
-        fprintf(file, "%s|%s|", arr[i].id, arr[i].name);
-        
-        // Write marks separated by commas
-        for (int j = 0; j < NUM_SUBJECTS; j++) {
-            fprintf(file, "%d", arr[i].marks[j]);
-            if (j < NUM_SUBJECTS - 1) {
-                fprintf(file, ",");
-            }
-        }
-        
-        // Write average, grade, and active status
-        fprintf(file, "|%.2f|%c|%d\n", arr[i].average, arr[i].grade, arr[i].active);
+        writeStudentRecord(file, &arr[i]);
     }
     
     fclose(file);
 }
 
+// Write one student record in the data file format
+void writeStudentRecord(FILE *file, const Student *s) {
+    fprintf(file, "%s|%s|", s->id, s->name);
+    
+    // Write marks separated by commas
+    for (int j = 0; j < NUM_SUBJECTS; j++) {
+        fprintf(file, "%d", s->marks[j]);
+        if (j < NUM_SUBJECTS - 1) {
+            fprintf(file, ",");
+        }
+    }
+    
+    // Write average, grade, and active status
+    fprintf(file, "|%.2f|%c|%d\n", s->average, s->grade, s->active);
+}
+
 // Add a new student record
 void addStudent(Student arr[], int *count) {
     if (*count >= MAX_STUDENTS) {
@@ -604,6 +685,525 @@ void generateReport(Student arr[], int count) {
     waitForEnter();
 }
 
+// Filter students with a query expression and stream the matches
+void filterStudents(Student arr[], int count) {
+    FilterIndex index;
+    FilterQuery query;
+    char input[MAX_FILTER_LENGTH];
+    
+    system("cls || clear");
+    printf("\n=== Filter Students ===\n\n");
+    
+    if (count == 0) {
+        printf("No students in the system.\n");
+        waitForEnter();
+        return;
+    }
+    
+    printf("Fields:    grade, active, average (avg), mark1-mark%d, anymark, allmarks\n", NUM_SUBJECTS);
+    printf("Operators: = != < <= > >=, combined with and, or, not and ( )\n");
+    printf("Example:   (grade = D or grade = F) and anymark < 40\n");
+    printf("Only active students are matched unless the filter mentions 'active'.\n");
+    
+    // Indexes stay valid for the whole session since records cannot change here
+    buildFilterIndex(arr, count, &index);
+    
+    while (1) {
+        printf("\nEnter filter (press Enter to return): ");
+        if (fgets(input, sizeof(input), stdin) == NULL) {
+            return;
+        }
+        
+        // Remove newline character, or discard the rest of a line that did not fit
+        size_t len = strlen(input);
+        if (len > 0 && input[len - 1] == '\n') {
+            input[len - 1] = '\0';
+        } else if (!feof(stdin)) {
+            clearInputBuffer();
+            printf("Error: Filter is too long\n");
+            continue;
+        }
+        
+        if (strlen(input) == 0) {
+            return;
+        }
+        
+        double startTime = currentTimeMs();
+        
+        if (!parseFilter(input, &query)) {
+            printf("Error: %s\n", query.error);
+            continue;
+        }
+        
+        Bitmap result;
+        evaluateFilter(&query, query.root, &index, &result);
+        if (!query.usesActive) {
+            bitmapAnd(&result, &index.activeBits[1]);
+        }
+        
+        double queryTime = currentTimeMs() - startTime;
+        
+        // Stream matching records straight from the result bitmap
+        printf("\n%-15s %-25s %-10s %-6s\n", "ID", "Name", "Average", "Grade");
+        printf("--------------------------------------------------------\n");
+        
+        int matchCount = 0;
+        for (int i = 0; i < count; i++) {
+            if (bitmapTest(&result, i)) {
+                printf("%-15s %-25s %-10.2f %-6c\n",
+                       arr[i].id, arr[i].name, arr[i].average, arr[i].grade);
+                matchCount++;
+            }
+        }
+        
+        if (matchCount == 0) {
+            printf("No students match this filter.\n");
+        } else {
+            printf("--------------------------------------------------------\n");
+        }
+        printf("Total: %d of %d students matched in %.3f ms\n", matchCount, count, queryTime);
+        
+        if (matchCount == 0) {
+            continue;
+        }
+        
+        printf("\nExport matches to file? (1 for Yes, 0 for No): ");
+        int exportResults = getIntegerInput(0, 1);
+        
+        if (exportResults) {
+            // Exported records use the same format as the data file
+            FILE *exportFile = fopen(FILTER_FILENAME, "w");
+            if (exportFile == NULL) {
+                printf("Error: Could not create export file %s.\n", FILTER_FILENAME);
+                continue;
+            }
+            
+            for (int i = 0; i < count; i++) {
+                if (bitmapTest(&result, i)) {
+                    writeStudentRecord(exportFile, &arr[i]);
+                }
+            }
+            
+            fclose(exportFile);
+            printf("%d records exported to %s successfully.\n", matchCount, FILTER_FILENAME);
+        }
+    }
+}
+
+// Build bitmap indexes on grade and active status, and columns for range scans
+void buildFilterIndex(Student arr[], int count, FilterIndex *index) {
+    index->count = count;
+    
+    for (int g = 0; g < NUM_GRADES; g++) {
+        bitmapClear(&index->gradeBits[g]);
+    }
+    bitmapClear(&index->activeBits[0]);
+    bitmapClear(&index->activeBits[1]);
+    
+    for (int i = 0; i < count; i++) {
+        int slot = gradeSlot(arr[i].grade);
+        if (slot != -1) {
+            bitmapSet(&index->gradeBits[slot], i);
+        }
+        bitmapSet(&index->activeBits[arr[i].active ? 1 : 0], i);
+        
+        // Compare averages at the 2 decimals shown in lists and stored in the data file
+        index->averageCol[i] = (float)(int)(arr[i].average * 100.0f + 0.5f) / 100.0f;
+        for (int j = 0; j < NUM_SUBJECTS; j++) {
+            index->markCol[j][i] = arr[i].marks[j];
+        }
+    }
+}
+
+// Parse a filter expression, returns 1 on success or 0 with query->error set
+int parseFilter(const char *text, FilterQuery *query) {
+    query->tokenCount = 0;
+    query->pos = 0;
+    query->nodeCount = 0;
+    query->usesActive = 0;
+    query->error[0] = '\0';
+    
+    if (!tokenizeFilter(text, query)) return 0;
+    
+    query->root = parseFilterOr(query);
+    if (query->root == -1) return 0;
+    
+    if (query->pos < query->tokenCount) {
+        snprintf(query->error, sizeof(query->error), "Unexpected '%s'", query->tokens[query->pos]);
+        return 0;
+    }
+    
+    return 1;
+}
+
+// Split a filter expression into words, operators and parentheses
+int tokenizeFilter(const char *text, FilterQuery *query) {
+    int i = 0;
+    
+    while (text[i] != '\0') {
+        if (isspace((unsigned char)text[i])) {
+            i++;
+            continue;
+        }
+        
+        if (query->tokenCount >= MAX_FILTER_TOKENS) {
+            snprintf(query->error, sizeof(query->error), "Filter is too long");
+            return 0;
+        }
+        
+        char *token = query->tokens[query->tokenCount];
+        int len = 0;
+        
+        if (text[i] == '(' || text[i] == ')') {
+            token[len++] = text[i++];
+        } else if (strchr("=!<>", text[i]) != NULL) {
+            while (text[i] != '\0' && strchr("=!<>", text[i]) != NULL && len < 2) {
+                token[len++] = text[i++];
+            }
+        } else if (isalnum((unsigned char)text[i]) || text[i] == '.') {
+            while (isalnum((unsigned char)text[i]) || text[i] == '.') {
+                if (len >= MAX_TOKEN_LENGTH - 1) {
+                    snprintf(query->error, sizeof(query->error), "Word too long in filter");
+                    return 0;
+                }
+                token[len++] = (char)tolower((unsigned char)text[i++]);
+            }
+        } else {
+            snprintf(query->error, sizeof(query->error), "Unexpected character '%c'", text[i]);
+            return 0;
+        }
+        
+        token[len] = '\0';
+        query->tokenCount++;
+    }
+    
+    if (query->tokenCount == 0) {
+        snprintf(query->error, sizeof(query->error), "Empty filter");
+        return 0;
+    }
+    
+    return 1;
+}
+
+// Parse: or-expression := and-expression { "or" and-expression }
+int parseFilterOr(FilterQuery *query) {
+    int left = parseFilterAnd(query);
+    
+    while (left != -1 && query->pos < query->tokenCount &&
+           strcmp(query->tokens[query->pos], "or") == 0) {
+        query->pos++;
+        int right = parseFilterAnd(query);
+        if (right == -1) return -1;
+        left = addFilterNode(query, NODE_OR, left, right);
+    }
+    
+    return left;
+}
+
+// Parse: and-expression := unary { "and" unary }
+int parseFilterAnd(FilterQuery *query) {
+    int left = parseFilterUnary(query);
+    
+    while (left != -1 && query->pos < query->tokenCount &&
+           strcmp(query->tokens[query->pos], "and") == 0) {
+        query->pos++;
+        int right = parseFilterUnary(query);
+        if (right == -1) return -1;
+        left = addFilterNode(query, NODE_AND, left, right);
+    }
+    
+    return left;
+}
+
+// Parse: unary := "not" unary | "(" or-expression ")" | predicate
+int parseFilterUnary(FilterQuery *query) {
+    if (query->pos >= query->tokenCount) {
+        snprintf(query->error, sizeof(query->error), "Filter ends unexpectedly");
+        return -1;
+    }
+    
+    if (strcmp(query->tokens[query->pos], "not") == 0) {
+        query->pos++;
+        int child = parseFilterUnary(query);
+        if (child == -1) return -1;
+        return addFilterNode(query, NODE_NOT, child, -1);
+    }
+    
+    if (strcmp(query->tokens[query->pos], "(") == 0) {
+        query->pos++;
+        int inner = parseFilterOr(query);
+        if (inner == -1) return -1;
+        
+        if (query->pos >= query->tokenCount || strcmp(query->tokens[query->pos], ")") != 0) {
+            snprintf(query->error, sizeof(query->error), "Missing ')'");
+            return -1;
+        }
+        query->pos++;
+        return inner;
+    }
+    
+    return parseFilterPredicate(query);
+}
+
+// Parse: predicate := field operator value
+int parseFilterPredicate(FilterQuery *query) {
+    if (query->pos + 3 > query->tokenCount) {
+        snprintf(query->error, sizeof(query->error), "Incomplete condition near '%s'",
+                 query->tokens[query->pos]);
+        return -1;
+    }
+    
+    const char *fieldName = query->tokens[query->pos];
+    const char *opName = query->tokens[query->pos + 1];
+    const char *valueText = query->tokens[query->pos + 2];
+    FilterField field;
+    FilterOp op;
+    int subject = 0;
+    
+    // Identify the field
+    if (strcmp(fieldName, "grade") == 0) {
+        field = FIELD_GRADE;
+    } else if (strcmp(fieldName, "active") == 0) {
+        field = FIELD_ACTIVE;
+        query->usesActive = 1;
+    } else if (strcmp(fieldName, "average") == 0 || strcmp(fieldName, "avg") == 0) {
+        field = FIELD_AVERAGE;
+    } else if (strcmp(fieldName, "anymark") == 0) {
+        field = FIELD_ANY_MARK;
+    } else if (strcmp(fieldName, "allmarks") == 0) {
+        field = FIELD_ALL_MARKS;
+    } else if (strncmp(fieldName, "mark", 4) == 0 && isdigit((unsigned char)fieldName[4])) {
+        char *end;
+        long number = strtol(fieldName + 4, &end, 10);
+        if (*end != '\0') {
+            snprintf(query->error, sizeof(query->error), "Unknown field '%s'", fieldName);
+            return -1;
+        }
+        if (number < 1 || number > NUM_SUBJECTS) {
+            snprintf(query->error, sizeof(query->error), "Subject must be mark1 to mark%d", NUM_SUBJECTS);
+            return -1;
+        }
+        field = FIELD_MARK;
+        subject = (int)number - 1;
+    } else {
+        snprintf(query->error, sizeof(query->error), "Unknown field '%s'", fieldName);
+        return -1;
+    }
+    
+    // Identify the operator
+    if (strcmp(opName, "=") == 0 || strcmp(opName, "==") == 0) op = OP_EQ;
+    else if (strcmp(opName, "!=") == 0) op = OP_NE;
+    else if (strcmp(opName, "<") == 0) op = OP_LT;
+    else if (strcmp(opName, "<=") == 0) op = OP_LE;
+    else if (strcmp(opName, ">") == 0) op = OP_GT;
+    else if (strcmp(opName, ">=") == 0) op = OP_GE;
+    else {
+        snprintf(query->error, sizeof(query->error), "Unknown operator '%s'", opName);
+        return -1;
+    }
+    
+    if ((field == FIELD_GRADE || field == FIELD_ACTIVE) && op != OP_EQ && op != OP_NE) {
+        snprintf(query->error, sizeof(query->error), "'%s' only supports = and !=", fieldName);
+        return -1;
+    }
+    
+    int node = addFilterNode(query, NODE_PREDICATE, -1, -1);
+    if (node == -1) return -1;
+    
+    FilterNode *pred = &query->nodes[node];
+    pred->field = field;
+    pred->subject = subject;
+    pred->op = op;
+    
+    // Parse the value
+    if (field == FIELD_GRADE) {
+        char letter = (char)toupper((unsigned char)valueText[0]);
+        if (valueText[1] != '\0' || gradeSlot(letter) == -1) {
+            snprintf(query->error, sizeof(query->error), "Grade must be A, B, C, D or F");
+            return -1;
+        }
+        pred->grade = letter;
+    } else {
+        char *end;
+        pred->value = strtof(valueText, &end);
+        if (*end != '\0') {
+            snprintf(query->error, sizeof(query->error), "Invalid number '%s'", valueText);
+            return -1;
+        }
+        if (field == FIELD_ACTIVE && pred->value != 0.0f && pred->value != 1.0f) {
+            snprintf(query->error, sizeof(query->error), "Active must be 0 or 1");
+            return -1;
+        }
+    }
+    
+    query->pos += 3;
+    return node;
+}
+
+// Append a node to the expression, returns its index or -1 if full
+int addFilterNode(FilterQuery *query, FilterNodeType type, int left, int right) {
+    if (query->nodeCount >= MAX_FILTER_NODES) {
+        snprintf(query->error, sizeof(query->error), "Filter is too complex");
+        return -1;
+    }
+    
+    FilterNode *node = &query->nodes[query->nodeCount];
+    node->type = type;
+    node->left = left;
+    node->right = right;
+    
+    return query->nodeCount++;
+}
+
+// Evaluate an expression node into a bitmap of matching records
+void evaluateFilter(FilterQuery *query, int node, FilterIndex *index, Bitmap *out) {
+    FilterNode *n = &query->nodes[node];
+    Bitmap other;
+    
+    switch (n->type) {
+        case NODE_AND:
+            evaluateFilter(query, n->left, index, out);
+            evaluateFilter(query, n->right, index, &other);
+            bitmapAnd(out, &other);
+            return;
+        case NODE_OR:
+            evaluateFilter(query, n->left, index, out);
+            evaluateFilter(query, n->right, index, &other);
+            bitmapOr(out, &other);
+            return;
+        case NODE_NOT:
+            evaluateFilter(query, n->left, index, out);
+            bitmapNot(out, index->count);
+            return;
+        case NODE_PREDICATE:
+            break;
+    }
+    
+    switch (n->field) {
+        case FIELD_GRADE:
+            // Equality lookups come straight from the bitmap index
+            *out = index->gradeBits[gradeSlot(n->grade)];
+            if (n->op == OP_NE) bitmapNot(out, index->count);
+            break;
+        case FIELD_ACTIVE:
+            *out = index->activeBits[n->value != 0.0f ? 1 : 0];
+            if (n->op == OP_NE) bitmapNot(out, index->count);
+            break;
+        case FIELD_AVERAGE:
+            scanColumnFloat(index->averageCol, index->count, n->op, n->value, out);
+            break;
+        case FIELD_MARK:
+            scanColumnInt(index->markCol[n->subject], index->count, n->op, n->value, out);
+            break;
+        case FIELD_ANY_MARK:
+        case FIELD_ALL_MARKS:
+            scanColumnInt(index->markCol[0], index->count, n->op, n->value, out);
+            for (int j = 1; j < NUM_SUBJECTS; j++) {
+                scanColumnInt(index->markCol[j], index->count, n->op, n->value, &other);
+                if (n->field == FIELD_ANY_MARK) bitmapOr(out, &other);
+                else bitmapAnd(out, &other);
+            }
+            break;
+    }
+}
+
+// Scan a column of floats and mark the records that satisfy the comparison
+void scanColumnFloat(const float col[], int count, FilterOp op, float value, Bitmap *out) {
+    bitmapClear(out);
+    for (int i = 0; i < count; i++) {
+        if (compareValue(col[i], op, value)) {
+            bitmapSet(out, i);
+        }
+    }
+}
+
+// Scan a column of integers and mark the records that satisfy the comparison
+void scanColumnInt(const int col[], int count, FilterOp op, float value, Bitmap *out) {
+    bitmapClear(out);
+    for (int i = 0; i < count; i++) {
+        if (compareValue((float)col[i], op, value)) {
+            bitmapSet(out, i);
+        }
+    }
+}
+
+// Apply a comparison operator
+int compareValue(float x, FilterOp op, float value) {
+    switch (op) {
+        case OP_EQ: return x == value;
+        case OP_NE: return x != value;
+        case OP_LT: return x < value;
+        case OP_LE: return x <= value;
+        case OP_GT: return x > value;
+        case OP_GE: return x >= value;
+    }
+    return 0;
+}
+
+// Map a grade letter to its index slot, returns -1 for unknown grades
+int gradeSlot(char grade) {
+    switch (grade) {
+        case 'A': return 0;
+        case 'B': return 1;
+        case 'C': return 2;
+        case 'D': return 3;
+        case 'F': return 4;
+        default: return -1;
+    }
+}
+
+// Remove all records from a bitmap
+void bitmapClear(Bitmap *b) {
+    memset(b->words, 0, sizeof(b->words));
+}
+
+// Add record i to a bitmap
+void bitmapSet(Bitmap *b, int i) {
+    b->words[i / 32] |= (uint32_t)1 << (i % 32);
+}
+
+// Check whether record i is in a bitmap
+int bitmapTest(const Bitmap *b, int i) {
+    return (b->words[i / 32] >> (i % 32)) & 1;
+}
+
+// Keep only records present in both bitmaps
+void bitmapAnd(Bitmap *dst, const Bitmap *src) {
+    for (int w = 0; w < BITMAP_WORDS; w++) {
+        dst->words[w] &= src->words[w];
+    }
+}
+
+// Add all records from src to dst
+void bitmapOr(Bitmap *dst, const Bitmap *src) {
+    for (int w = 0; w < BITMAP_WORDS; w++) {
+        dst->words[w] |= src->words[w];
+    }
+}
+
+// Invert a bitmap, limited to the first count records
+void bitmapNot(Bitmap *b, int count) {
+    for (int w = 0; w < BITMAP_WORDS; w++) {
+        b->words[w] = ~b->words[w];
+    }
+    
+    // Clear bits beyond the last record
+    for (int i = count; i < BITMAP_WORDS * 32; i++) {
+        b->words[i / 32] &= ~((uint32_t)1 << (i % 32));
+    }
+}
+
+// Current time in milliseconds, used to time filter queries
+double currentTimeMs() {
+#ifdef TIME_UTC
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#else
+    return (double)clock() * 1000.0 / CLOCKS_PER_SEC;
+#endif
+}
+
 // Clear input buffer
 void clearInputBuffer() {
     int c;